@@ -13,11 +13,7 @@ namespace VLT {
 // Helpers
 //
 
-/// Reads the contents of the file as a vector<byte>.
-/// @param p Path to file.
-/// @return std::vector<byte> filled with the file contents.
-/// @throw std::filesystem::filesystem_error
-static std::vector<std::byte> read_file_contents(const std::filesystem::path& p) {
+std::vector<std::byte> read_file_contents(const std::filesystem::path& p) {
   try {
     std::vector<std::byte> contents(std::filesystem::file_size(p));
     std::ifstream file{};
@@ -30,7 +26,7 @@ static std::vector<std::byte> read_file_contents(const std::filesystem::path& p)
   }
 }
 
-static void write_file_contents(const std::filesystem::path& p, const std::vector<std::byte>& contents) {
+void write_file_contents(const std::filesystem::path& p, std::span<const std::byte> contents) {
   try {
     std::ofstream file{};
     file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
@@ -65,8 +61,8 @@ struct FSEQv2_Variable {
   static constexpr std::size_t HEADER_LENGTH{sizeof(size_type) + CODE_LENGTH};
   static constexpr std::size_t MAX_DATA_LENGTH{std::numeric_limits<size_type>::max() - HEADER_LENGTH};
   size_type size{};
-  std::string code;
-  std::string data;
+  std::string_view code;  // Views into the raw buffer the variable was parsed from
+  std::string_view data;
 };
 static FSEQv2_Variable parse_fseq_variable(std::span<const std::byte> raw) {
   FSEQv2_Variable var;
@@ -77,19 +73,20 @@ static FSEQv2_Variable parse_fseq_variable(std::span<const std::byte> raw) {
   raw = raw.subspan(sizeof(FSEQv2_Variable::size_type));
 
   if (var.size == 0) return var;
+  if (var.size < FSEQv2_Variable::HEADER_LENGTH) throw std::runtime_error{"variable size too small"};
 
-  var.code = std::string(reinterpret_cast<const char*>(raw.data()), FSEQv2_Variable::CODE_LENGTH);
+  var.code = std::string_view(reinterpret_cast<const char*>(raw.data()), FSEQv2_Variable::CODE_LENGTH);
   raw = raw.subspan(FSEQv2_Variable::CODE_LENGTH);
 
   auto data_size = var.size - 4;
   if (raw.size() < data_size) {
     throw std::runtime_error{"variable size overrun"};
   }
-  var.data = std::string(reinterpret_cast<const char*>(raw.data()), data_size);
+  var.data = std::string_view(reinterpret_cast<const char*>(raw.data()), data_size);
 
   return var;
 }
-static std::vector<std::byte> serialize_fseq_variable(std::string code, const std::string& data) {
+static std::vector<std::byte> serialize_fseq_variable(std::string_view code, std::string_view data) {
   if (code.size() != FSEQv2_Variable::CODE_LENGTH) {
     throw std::invalid_argument{"serialize_fseq_variable: invalid code length"};
   }
@@ -171,14 +168,36 @@ static_assert(sizeof(FSEQv2_Header) == 32, "FSEQv2_Header size mismatch");
 //
 // FSEQv2
 //
-FSEQv2::FSEQv2(uint32_t num_channels, std::chrono::milliseconds step_time)
-    : num_channels_{num_channels}, step_time_{step_time} {
+FSEQv2::FSEQv2(uint32_t num_channels, std::chrono::milliseconds step_time, const allocator_type& alloc)
+    : num_channels_{num_channels}, step_time_{step_time}, variables_{alloc}, frame_data_{alloc} {
   if (step_time_.count() > std::numeric_limits<uint8_t>::max()) {
     throw std::invalid_argument{"FSEQv2: too long step time"};
   }
 }
-FSEQv2::FSEQv2(const std::filesystem::path& p) { parse_from_(read_file_contents(p)); }
-FSEQv2::FSEQv2(std::span<const std::byte> contents) { parse_from_(contents); }
+FSEQv2::FSEQv2(const std::filesystem::path& p, const allocator_type& alloc)
+    : variables_{alloc}, frame_data_{alloc} {
+  parse_from_(read_file_contents(p));
+}
+FSEQv2::FSEQv2(std::span<const std::byte> contents, const allocator_type& alloc)
+    : variables_{alloc}, frame_data_{alloc} {
+  parse_from_(contents);
+}
+FSEQv2::FSEQv2(const FSEQv2& other, const allocator_type& alloc)
+    : version_minor_{other.version_minor_},
+      num_channels_{other.num_channels_},
+      num_frames_{other.num_frames_},
+      step_time_{other.step_time_},
+      created_{other.created_},
+      variables_{other.variables_, alloc},
+      frame_data_{other.frame_data_, alloc} {}
+FSEQv2::FSEQv2(FSEQv2&& other, const allocator_type& alloc)
+    : version_minor_{other.version_minor_},
+      num_channels_{other.num_channels_},
+      num_frames_{other.num_frames_},
+      step_time_{other.step_time_},
+      created_{other.created_},
+      variables_{std::move(other.variables_), alloc},
+      frame_data_{std::move(other.frame_data_), alloc} {}
 
 std::vector<std::byte> FSEQv2::serialize() const {
   // First, serialize the variables
@@ -222,11 +241,25 @@ void FSEQv2::serialize(const std::filesystem::path& output_file) const {
   write_file_contents(output_file, serialize());
 }
 
+FSEQv2& FSEQv2::set_version_minor(uint8_t version_minor) {
+  version_minor_ = version_minor;
+  return *this;
+}
+
+FSEQv2& FSEQv2::set_created(time_point created) {
+  created_ = created;
+  return *this;
+}
+
 std::chrono::milliseconds FSEQv2::total_duration() const { return (step_time_ * num_frames_); }
 
-FSEQv2& FSEQv2::add_variable(std::string code, const std::string& value) {
+FSEQv2& FSEQv2::add_variable(std::string_view code, std::string_view value) {
   if (code.size() != FSEQv2_Variable::CODE_LENGTH) throw std::invalid_argument{"Invalid code length"};
-  variables_[code] = value;
+  variables_.insert_or_assign(std::pmr::string{code, get_allocator()}, value);
+  return *this;
+}
+FSEQv2& FSEQv2::remove_variable(std::string_view code) {
+  if (auto it = variables_.find(code); it != variables_.end()) variables_.erase(it);
   return *this;
 }
 
@@ -239,7 +272,7 @@ FSEQv2& FSEQv2::reserve_frames(std::size_t num_frames) {
   frame_data_.reserve(num_frames * num_channels_);
   return *this;
 }
-FSEQv2& FSEQv2::add_frame(const std::vector<std::byte>& frame_data) {
+FSEQv2& FSEQv2::add_frame(std::span<const std::byte> frame_data) {
   if (frame_data.size() != num_channels_) {
     throw std::invalid_argument{"FSEQv2::add_frame: invalid channel count"};
   }
@@ -249,6 +282,7 @@ FSEQv2& FSEQv2::add_frame(const std::vector<std::byte>& frame_data) {
 }
 
 void FSEQv2::parse_from_(std::span<const std::byte> contents) {
+  if (contents.size() < sizeof(FSEQv2_Header)) throw std::runtime_error{"too short for a header"};
   FSEQv2_Header header{contents.first(sizeof(FSEQv2_Header))};
 
   // Save required data for later use
@@ -258,20 +292,28 @@ void FSEQv2::parse_from_(std::span<const std::byte> contents) {
   step_time_ = std::chrono::milliseconds{le_to_native(header.step_time)};
   created_ = FSEQv2::time_point{std::chrono::microseconds{le_to_native(header.timestamp_us)}};
 
+  // Check that the blocks lie in order within the contents before slicing them
+  std::size_t var_data_offset{le_to_native(header.var_data_offset)};
+  std::size_t ch_data_offset{le_to_native(header.ch_data_offset)};
+  if (var_data_offset < sizeof(FSEQv2_Header) || var_data_offset > ch_data_offset ||
+      ch_data_offset > contents.size()) {
+    throw std::runtime_error{"invalid data offsets"};
+  }
+
   // Process variables
-  auto variable_data_length = header.ch_data_offset - header.var_data_offset;
-  auto variable_data = contents.subspan(header.var_data_offset, variable_data_length);
+  auto variable_data = contents.subspan(var_data_offset, ch_data_offset - var_data_offset);
   while (!variable_data.empty()) {
     auto var = parse_fseq_variable(variable_data);
     if (var.size == 0) break;
-    variables_[var.code] = var.data;
+    variables_.insert_or_assign(std::pmr::string{var.code, get_allocator()}, var.data);
     variable_data = variable_data.subspan(var.size);
   }
 
-  frame_data_.assign_range(contents.subspan(header.ch_data_offset));
-  if (frame_data_.size() != (num_channels_ * num_frames_)) {
+  auto channel_data = contents.subspan(ch_data_offset);
+  if (channel_data.size() != (static_cast<std::size_t>(num_channels_) * num_frames_)) {
     throw std::runtime_error{"channel data block size wrong"};
   }
+  frame_data_.assign_range(channel_data);
 }
 //
 // End FSEQv2
@@ -286,6 +328,9 @@ std::byte FSEQv2::Frame::channel_data(std::size_t ch_idx) const {
   auto frame_data_offset = (idx_ * seq_->num_channels_) + ch_idx;
   return seq_->frame_data_.at((idx_ * seq_->num_channels_) + ch_idx);
 }
+std::span<const std::byte> FSEQv2::Frame::data() const {
+  return std::span{seq_->frame_data_}.subspan(idx_ * seq_->num_channels_, seq_->num_channels_);
+}
 std::optional<FSEQv2::Frame> FSEQv2::Frame::next() const { return seq_->frame(idx_ + 1); }
 std::string FSEQv2::Frame::dump(std::size_t n_chans, const Frame* previous) const {
   std::string ch_data;
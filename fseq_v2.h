@@ -4,33 +4,66 @@
 #include <cstddef>
 #include <filesystem>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace VLT {
 
+/// Reads the contents of the file as a vector<byte>.
+/// @param p Path to file.
+/// @return std::vector<byte> filled with the file contents.
+/// @throw std::filesystem::filesystem_error
+std::vector<std::byte> read_file_contents(const std::filesystem::path& p);
+
+/// Replaces the contents of the file with `contents`.
+/// @throw std::filesystem::filesystem_error
+void write_file_contents(const std::filesystem::path& p, std::span<const std::byte> contents);
+
 class FSEQv2 {
  public:
+  /// All internal storage (variables and channel data) is obtained from this allocator. A
+  /// std::pmr::memory_resource* converts implicitly, so e.g. a monotonic arena can be passed directly.
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+  using variable_map = std::pmr::map<std::pmr::string, std::pmr::string, std::less<>>;
+
   /// Create FSEQv2 data from scratch
   /// @param num_channels The number of channels used
-  FSEQv2(uint32_t num_channels, std::chrono::milliseconds step_time);
+  FSEQv2(uint32_t num_channels, std::chrono::milliseconds step_time, const allocator_type& alloc = {});
 
   /// Read FSEQv2 data from a file
   /// @throw In addition to what the byte buffer overload might throw: TODO:
   /// list possible exceptions from reading a file
-  FSEQv2(const std::filesystem::path&);
+  FSEQv2(const std::filesystem::path&, const allocator_type& alloc = {});
 
   /// Read FSEQv2 data from a byte buffer
   /// @throw TODO: list possible excptions from FSEQ intepretation
-  FSEQv2(std::span<const std::byte>);
+  FSEQv2(std::span<const std::byte>, const allocator_type& alloc = {});
+
+  /// Like the pmr containers, a plain copy allocates from the default memory resource rather than the
+  /// source's; use the allocator-extended overloads to copy or move into a specific resource.
+  FSEQv2(const FSEQv2&) = default;
+  FSEQv2(FSEQv2&&) = default;
+  FSEQv2(const FSEQv2& other, const allocator_type& alloc);
+  FSEQv2(FSEQv2&& other, const allocator_type& alloc);
+  FSEQv2& operator=(const FSEQv2&) = default;
+  FSEQv2& operator=(FSEQv2&&) = default;
+
+  allocator_type get_allocator() const { return frame_data_.get_allocator(); }
 
   std::vector<std::byte> serialize() const;
   void serialize(const std::filesystem::path&) const;
 
+  uint8_t version_minor() const { return version_minor_; }
+  FSEQv2& set_version_minor(uint8_t version_minor);
+
   using clock = std::chrono::system_clock;
   using time_point = std::chrono::time_point<clock, std::chrono::microseconds>;
   time_point created() const { return created_; }
+  FSEQv2& set_created(time_point created);
 
   uint32_t num_channels() const { return num_channels_; }
   uint32_t num_frames() const { return num_frames_; }
@@ -38,13 +71,16 @@ class FSEQv2 {
   std::chrono::milliseconds step_duration() const { return step_time_; }
   std::chrono::milliseconds total_duration() const;
 
-  const std::map<std::string, std::string>& variables() const { return variables_; }
-  FSEQv2& add_variable(std::string code, const std::string& value);
+  const variable_map& variables() const { return variables_; }
+  FSEQv2& add_variable(std::string_view code, std::string_view value);
+  FSEQv2& remove_variable(std::string_view code);
 
   class Frame {
    public:
     std::chrono::milliseconds offset() const;
     std::byte channel_data(std::size_t channel_index) const;
+    /// All channel data of this frame, num_channels() bytes
+    std::span<const std::byte> data() const;
     std::optional<Frame> next() const;
     std::string dump(std::size_t n_first_channels = 0, const Frame* previous = nullptr) const;
 
@@ -57,7 +93,8 @@ class FSEQv2 {
 
   std::optional<Frame> frame(std::size_t index = 0) const;
   FSEQv2& reserve_frames(std::size_t num_frames);
-  FSEQv2& add_frame(const std::vector<std::byte>& frame_data);
+  FSEQv2& add_frame(std::span<const std::byte> frame_data);
+  FSEQv2& add_frame(const std::vector<std::byte>& frame_data) { return add_frame(std::span{frame_data}); }
 
  private:
   friend class Frame;
@@ -68,8 +105,8 @@ class FSEQv2 {
   std::chrono::milliseconds step_time_;
   time_point created_{std::chrono::time_point_cast<std::chrono::microseconds>(clock::now())};
 
-  std::map<std::string, std::string> variables_;
-  std::vector<std::byte> frame_data_;
+  variable_map variables_;
+  std::pmr::vector<std::byte> frame_data_;
 };
 
 }  // namespace VLT
\ No newline at end of file
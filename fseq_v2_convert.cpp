@@ -0,0 +1,47 @@
+#include "fseq_v2_convert.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace VLT {
+
+FSEQv2 convert(const FSEQv2& in, const ConvertOptions& opts, const FSEQv2::allocator_type& alloc) {
+  std::vector<uint32_t> channels;  // Source channel of each output channel, if extracting a subset
+  for (const auto& [first, last] : opts.channels) {
+    if (last >= in.num_channels()) throw std::out_of_range{"channel range exceeds channel count"};
+    for (auto ch = first; ch <= last; ch++) channels.push_back(ch);
+  }
+
+  auto step_time = opts.step_time.value_or(in.step_duration());
+  const bool resample{step_time != in.step_duration()};
+  std::size_t num_frames = in.num_frames();
+  if (resample) {
+    if (in.step_duration().count() == 0) throw std::runtime_error{"cannot resample a zero step time"};
+    num_frames = (in.total_duration() + step_time - std::chrono::milliseconds{1}) / step_time;
+  }
+
+  auto num_channels = opts.channels.empty() ? in.num_channels() : static_cast<uint32_t>(channels.size());
+  FSEQv2 out{num_channels, step_time, alloc};
+  out.set_version_minor(in.version_minor()).set_created(in.created());
+  for (const auto& [code, value] : in.variables()) out.add_variable(code, value);
+  for (const auto& [code, value] : opts.set_variables) out.add_variable(code, value);
+  for (const auto& code : opts.unset_variables) out.remove_variable(code);
+
+  out.reserve_frames(num_frames);
+  std::vector<std::byte> frame_data(channels.size());
+  for (std::size_t idx = 0; idx < num_frames; idx++) {
+    // Nearest preceding source frame when resampling
+    auto frame = in.frame(resample ? (step_time * idx / in.step_duration()) : idx);
+    if (opts.channels.empty()) {
+      out.add_frame(frame->data());
+      continue;
+    }
+    auto source = frame->data();
+    std::ranges::transform(channels, frame_data.begin(), [&](uint32_t ch) { return source[ch]; });
+    out.add_frame(frame_data);
+  }
+  return out;
+}
+
+}  // namespace VLT
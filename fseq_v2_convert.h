@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fseq_v2.h"
+
+namespace VLT {
+
+/// Transformations applied by convert()
+struct ConvertOptions {
+  struct ChannelRange {
+    uint32_t first;
+    uint32_t last;  // Inclusive
+  };
+  /// Source channels to keep, in output order; all channels when empty
+  std::vector<ChannelRange> channels;
+  /// New step time. Each output frame takes the nearest preceding source frame, and the frame count is
+  /// rounded up so that the total duration is covered.
+  std::optional<std::chrono::milliseconds> step_time;
+  /// Variables are set before they are unset, so unsetting a code wins over setting it
+  std::vector<std::pair<std::string, std::string>> set_variables;
+  std::vector<std::string> unset_variables;
+};
+
+/// Applies the requested transformations to `in`, allocating the result from `alloc`. The creation time
+/// and minor version are carried over from `in`.
+/// @throw std::out_of_range if a requested channel does not exist in `in`
+/// @throw std::runtime_error if `in` cannot be resampled
+/// @throw std::invalid_argument for invalid variable codes or step time
+FSEQv2 convert(const FSEQv2& in, const ConvertOptions& opts, const FSEQv2::allocator_type& alloc = {});
+
+}  // namespace VLT
@@ -1,4 +1,5 @@
 #include "fseq_v2.h"
+#include "fseq_v2_convert.h"
 
 #include <catch2/catch_all.hpp>
 
@@ -70,6 +71,7 @@ TEST_CASE("FSEQv2 parsing & serializing") {
   std::optional<VLT::FSEQv2> dummy;
   REQUIRE_NOTHROW(dummy.emplace(dummy_show));
 
+  REQUIRE(dummy->version_minor() == 0);
   REQUIRE(dummy->created().time_since_epoch().count() == timestamp_us);
   REQUIRE(dummy->num_channels() == 4);
   REQUIRE(dummy->num_frames() == 4);
@@ -122,4 +124,110 @@ TEST_CASE("FSEQv2 parsing & serializing") {
   REQUIRE(frame.has_value() == false);
 
   REQUIRE(std::ranges::equal(dummy->serialize(), dummy_show) == true);
-}
\ No newline at end of file
+}
+
+TEST_CASE("FSEQv2 editing") {
+  VLT::FSEQv2 seq{3, std::chrono::milliseconds{50}};
+  seq.add_frame(std::vector{std::byte{0x01}, std::byte{0x02}, std::byte{0x03}});
+  seq.add_frame({std::byte{0x04}, std::byte{0x05}, std::byte{0x06}});
+
+  auto frame = seq.frame(1);
+  REQUIRE(frame.has_value() == true);
+  constexpr std::array expected{std::byte{0x04}, std::byte{0x05}, std::byte{0x06}};
+  REQUIRE(std::ranges::equal(frame->data(), expected));
+
+  seq.add_variable("mf", "song.wav").add_variable("sp", "VLT");
+  REQUIRE(seq.variables().size() == 2);
+  seq.remove_variable("mf").remove_variable("xx");
+  REQUIRE(seq.variables().size() == 1);
+  REQUIRE(seq.variables().contains("sp"));
+
+  auto created = VLT::FSEQv2::time_point{std::chrono::microseconds{1742822121000000}};
+  REQUIRE(seq.set_created(created).created() == created);
+  REQUIRE(seq.set_version_minor(1).version_minor() == 1);
+}
+
+TEST_CASE("FSEQv2 rejects truncated and corrupt data") {
+  VLT::FSEQv2 seq{4, std::chrono::milliseconds{20}};
+  seq.add_variable("mf", "song.wav");
+  seq.add_frame({std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04}});
+  const auto serialized = seq.serialize();
+  const auto contents = std::span<const std::byte>{serialized};
+
+  REQUIRE_THROWS_AS(VLT::FSEQv2{std::span<const std::byte>{}}, std::runtime_error);
+  REQUIRE_THROWS_AS(VLT::FSEQv2{contents.first(20)}, std::runtime_error);     // Within the header
+  REQUIRE_THROWS_AS(VLT::FSEQv2{contents.first(36)}, std::runtime_error);     // Within the variables
+  REQUIRE_THROWS_AS(VLT::FSEQv2{contents.first(contents.size() - 1)}, std::runtime_error);
+
+  auto corrupt = serialized;
+  corrupt[4] = corrupt[5] = std::byte{0xff};  // ch_data_offset past the end
+  REQUIRE_THROWS_AS(VLT::FSEQv2{std::span<const std::byte>{corrupt}}, std::runtime_error);
+
+  corrupt = serialized;
+  corrupt[32] = std::byte{0x03};  // Variable size smaller than its own header
+  corrupt[33] = std::byte{0x00};
+  REQUIRE_THROWS_AS(VLT::FSEQv2{std::span<const std::byte>{corrupt}}, std::runtime_error);
+}
+
+TEST_CASE("FSEQv2 conversion") {
+  // 5 frames of 4 channels, 50 ms apart; channel c of frame f holds 0xfc
+  VLT::FSEQv2 in{4, std::chrono::milliseconds{50}};
+  for (uint8_t f = 0; f < 5; f++) {
+    std::vector<std::byte> frame;
+    for (uint8_t c = 0; c < 4; c++) frame.push_back(std::byte{static_cast<uint8_t>((f << 4) | c)});
+    in.add_frame(frame);
+  }
+  in.add_variable("mf", "song.wav").set_version_minor(1);
+
+  VLT::ConvertOptions opts;
+
+  SECTION("no transformations round-trips") {
+    REQUIRE(std::ranges::equal(VLT::convert(in, opts).serialize(), in.serialize()));
+  }
+
+  SECTION("channel subset keeps the requested order") {
+    opts.channels = {{2, 3}, {0, 0}};
+    auto out = VLT::convert(in, opts);
+    REQUIRE(out.num_channels() == 3);
+    REQUIRE(out.num_frames() == 5);
+    constexpr std::array expected{std::byte{0x12}, std::byte{0x13}, std::byte{0x10}};
+    REQUIRE(std::ranges::equal(out.frame(1)->data(), expected));
+
+    opts.channels = {{3, 4}};
+    REQUIRE_THROWS_AS(VLT::convert(in, opts), std::out_of_range);
+  }
+
+  SECTION("resampling to a longer step rounds the frame count up") {
+    opts.step_time = std::chrono::milliseconds{100};
+    auto out = VLT::convert(in, opts);
+    REQUIRE(out.num_frames() == 3);  // 250 ms / 100 ms
+    REQUIRE(out.total_duration() == std::chrono::milliseconds{300});
+    REQUIRE(out.frame(0)->channel_data(0) == std::byte{0x00});
+    REQUIRE(out.frame(1)->channel_data(0) == std::byte{0x20});
+    REQUIRE(out.frame(2)->channel_data(0) == std::byte{0x40});
+  }
+
+  SECTION("resampling to a shorter step picks the nearest preceding frame") {
+    opts.step_time = std::chrono::milliseconds{20};
+    auto out = VLT::convert(in, opts);
+    REQUIRE(out.num_frames() == 13);                               // 250 ms / 20 ms
+    REQUIRE(out.frame(2)->channel_data(1) == std::byte{0x01});   // 40 ms -> 0 ms
+    REQUIRE(out.frame(3)->channel_data(1) == std::byte{0x11});   // 60 ms -> 50 ms
+    REQUIRE(out.frame(12)->channel_data(1) == std::byte{0x41});  // 240 ms -> 200 ms
+  }
+
+  SECTION("variables are set, then unset") {
+    opts.set_variables = {{"mf", "other.wav"}, {"sp", "VLT"}};
+    opts.unset_variables = {"sp"};
+    auto out = VLT::convert(in, opts);
+    REQUIRE(out.variables().size() == 1);
+    REQUIRE(out.variables().at("mf") == "other.wav");
+  }
+
+  SECTION("creation time and minor version are carried over") {
+    opts.channels = {{0, 1}};
+    auto out = VLT::convert(in, opts);
+    REQUIRE(out.created() == in.created());
+    REQUIRE(out.version_minor() == 1);
+  }
+}
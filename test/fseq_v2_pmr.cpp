@@ -0,0 +1,104 @@
+#include "fseq_v2.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <memory_resource>
+
+namespace {
+
+/// Makes the default memory resource refuse all allocations for its lifetime, so that any storage not
+/// obtained through an explicitly passed allocator throws std::bad_alloc.
+class NullDefaultResource {
+ public:
+  NullDefaultResource() : previous_{std::pmr::set_default_resource(std::pmr::null_memory_resource())} {}
+  ~NullDefaultResource() { std::pmr::set_default_resource(previous_); }
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+
+constexpr uint32_t num_channels{512};
+constexpr std::size_t num_frames{64};
+
+VLT::FSEQv2 make_preview(const VLT::FSEQv2::allocator_type& alloc) {
+  VLT::FSEQv2 seq{num_channels, std::chrono::milliseconds{25}, alloc};
+  seq.add_variable("mf", "a_media_file_name_long_enough_to_not_fit_sso.wav");
+  seq.add_variable("sp", "VLT preview renderer");
+  seq.reserve_frames(num_frames);
+  std::vector<std::byte> frame(num_channels);
+  for (std::size_t i = 0; i < num_frames; i++) {
+    std::ranges::fill(frame, std::byte{static_cast<uint8_t>(i)});
+    seq.add_frame(frame);
+  }
+  return seq;
+}
+
+}  // namespace
+
+TEST_CASE("FSEQv2 allocates internal storage from the given memory resource") {
+  std::pmr::monotonic_buffer_resource arena;
+  const auto serialized = make_preview({}).serialize();
+
+  NullDefaultResource guard;
+
+  std::optional<VLT::FSEQv2> created;
+  REQUIRE_NOTHROW(created.emplace(make_preview(&arena)));
+  REQUIRE(created->get_allocator().resource() == &arena);
+  REQUIRE(created->num_frames() == num_frames);
+
+  std::optional<VLT::FSEQv2> parsed;
+  REQUIRE_NOTHROW(parsed.emplace(std::span<const std::byte>{serialized}, &arena));
+  REQUIRE(parsed->get_allocator().resource() == &arena);
+  REQUIRE(parsed->variables().size() == 2);
+  REQUIRE(parsed->variables().at("mf") == "a_media_file_name_long_enough_to_not_fit_sso.wav");
+  REQUIRE(parsed->frame(num_frames - 1)->channel_data(0) ==
+          std::byte{static_cast<uint8_t>(num_frames - 1)});
+
+  REQUIRE_THROWS_AS(make_preview({}), std::bad_alloc);
+}
+
+TEST_CASE("FSEQv2 allocator-extended copy and move") {
+  std::pmr::monotonic_buffer_resource arena;
+  const auto original = make_preview({});
+
+  std::pmr::vector<VLT::FSEQv2> previews{&arena};
+  previews.push_back(original);
+  previews.push_back(VLT::FSEQv2{original});
+  for (const auto& preview : previews) {
+    REQUIRE(preview.get_allocator().resource() == &arena);
+    REQUIRE(preview.num_frames() == original.num_frames());
+    REQUIRE(preview.variables() == original.variables());
+    REQUIRE(std::ranges::equal(preview.serialize(), original.serialize()));
+  }
+
+  // A plain copy does not inherit the source's resource
+  VLT::FSEQv2 copy{previews.front()};
+  REQUIRE(copy.get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("FSEQv2 construction/destruction throughput", "[.][benchmark]") {
+  const auto serialized = make_preview({}).serialize();
+  const auto contents = std::span<const std::byte>{serialized};
+
+  BENCHMARK("global heap: create") { return make_preview({}).num_frames(); };
+  BENCHMARK("global heap: parse") { return VLT::FSEQv2{contents}.num_frames(); };
+
+  // The arena only rewinds over a caller-owned buffer on release(), it never goes upstream
+  std::vector<std::byte> arena_buffer(1 << 20);
+  std::pmr::monotonic_buffer_resource arena{arena_buffer.data(), arena_buffer.size(),
+                                            std::pmr::null_memory_resource()};
+  BENCHMARK("monotonic arena: create") {
+    auto n = make_preview(&arena).num_frames();
+    arena.release();
+    return n;
+  };
+  BENCHMARK("monotonic arena: parse") {
+    auto n = VLT::FSEQv2{contents, &arena}.num_frames();
+    arena.release();
+    return n;
+  };
+
+  std::pmr::unsynchronized_pool_resource pool;
+  BENCHMARK("pool: create") { return make_preview(&pool).num_frames(); };
+  BENCHMARK("pool: parse") { return VLT::FSEQv2{contents, &pool}.num_frames(); };
+}
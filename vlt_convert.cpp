@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <queue>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fseq_v2.h"
+#include "fseq_v2_convert.h"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+//
+// Helpers
+//
+
+/// A fixed-capacity queue connecting two pipeline stages. push() blocks while the queue is full and pop()
+/// while it is empty; after close() pop() drains the remaining items and then returns std::nullopt, and
+/// push() drops its item and returns false.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(std::size_t capacity) : capacity_{capacity} {}
+
+  bool push(T item) {
+    std::unique_lock lock{mutex_};
+    not_full_.wait(lock, [this] { return items_.size() < capacity_ || closed_; });
+    if (closed_) return false;
+    items_.push(std::move(item));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  std::optional<T> pop() {
+    std::unique_lock lock{mutex_};
+    not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+    if (items_.empty()) return {};
+    T item{std::move(items_.front())};
+    items_.pop();
+    not_full_.notify_one();
+    return item;
+  }
+
+  void close() {
+    std::lock_guard lock{mutex_};
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  std::size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::queue<T> items_;
+  bool closed_{false};
+};
+
+template <std::integral T>
+std::optional<T> parse_number(std::string_view s) {
+  T value{};
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc{} || end != s.data() + s.size()) return {};
+  return value;
+}
+
+double to_mib(std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+//
+// End helpers
+//
+
+//
+// Options
+//
+struct Options {
+  fs::path input_dir;
+  fs::path output_dir;
+  static constexpr unsigned MAX_WORKERS{256};
+  unsigned workers{std::clamp(std::thread::hardware_concurrency(), 1u, MAX_WORKERS)};
+  VLT::ConvertOptions conversion;
+};
+
+void print_usage(const char* argv0) {
+  std::println(stderr, "Usage: {} [options] input_dir output_dir", argv0);
+  std::println(stderr, "Converts every .fseq file under input_dir into the same relative path under");
+  std::println(stderr, "output_dir.");
+  std::println(stderr, "Options:");
+  std::println(stderr, "  -j N                 worker threads, 1-{} (default: hardware concurrency)",
+               Options::MAX_WORKERS);
+  std::println(stderr, "  --channels A-B[,C]   keep only the given 0-based channels, in the given order");
+  std::println(stderr, "  --step-time MS       resample the frames to a new step time");
+  std::println(stderr, "  --set CODE=VALUE     add or replace a variable; CODE is two characters");
+  std::println(stderr, "  --unset CODE         remove a variable");
+}
+
+std::optional<std::vector<VLT::ConvertOptions::ChannelRange>> parse_channel_ranges(std::string_view s) {
+  std::vector<VLT::ConvertOptions::ChannelRange> ranges;
+  for (auto part : std::views::split(s, ',')) {
+    std::string_view range{part.begin(), part.end()};
+    auto dash = range.find('-');
+    auto first = parse_number<uint32_t>(range.substr(0, dash));
+    auto last = dash == std::string_view::npos ? first : parse_number<uint32_t>(range.substr(dash + 1));
+    if (!first || !last || *last < *first) return {};
+    ranges.push_back({*first, *last});
+  }
+  return ranges;
+}
+
+/// @return std::nullopt if the command line is invalid; the reason has already been printed.
+std::optional<Options> parse_options(int argc, char* argv[]) {
+  Options opts;
+  std::vector<std::string_view> positional;
+  for (int i = 1; i < argc; i++) {
+    std::string_view arg{argv[i]};
+    if (!arg.starts_with('-')) {
+      positional.push_back(arg);
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::println(stderr, "Missing value for {}", arg);
+      return {};
+    }
+    std::string_view value{argv[++i]};
+    if (arg == "-j") {
+      auto workers = parse_number<unsigned>(value);
+      if (!workers || *workers == 0 || *workers > Options::MAX_WORKERS) {
+        std::println(stderr, "Invalid worker count: {} (1-{})", value, Options::MAX_WORKERS);
+        return {};
+      }
+      opts.workers = *workers;
+    } else if (arg == "--channels") {
+      auto ranges = parse_channel_ranges(value);
+      if (!ranges) {
+        std::println(stderr, "Invalid channel ranges: {}", value);
+        return {};
+      }
+      opts.conversion.channels.append_range(*ranges);
+    } else if (arg == "--step-time") {
+      auto ms = parse_number<uint8_t>(value);
+      if (!ms || *ms == 0) {
+        std::println(stderr, "Invalid step time: {}", value);
+        return {};
+      }
+      opts.conversion.step_time = std::chrono::milliseconds{*ms};
+    } else if (arg == "--set") {
+      auto eq = value.find('=');
+      if (eq != 2) {
+        std::println(stderr, "Invalid variable assignment: {}", value);
+        return {};
+      }
+      opts.conversion.set_variables.emplace_back(value.substr(0, eq), value.substr(eq + 1));
+    } else if (arg == "--unset") {
+      if (value.size() != 2) {
+        std::println(stderr, "Invalid variable code: {}", value);
+        return {};
+      }
+      opts.conversion.unset_variables.emplace_back(value);
+    } else {
+      std::println(stderr, "Unknown option: {}", arg);
+      return {};
+    }
+  }
+  if (positional.size() != 2) return {};
+  opts.input_dir = positional[0];
+  opts.output_dir = positional[1];
+  return opts;
+}
+//
+// End Options
+//
+
+//
+// Pipeline
+//
+struct Job {
+  fs::path input;
+  fs::path output;
+  std::vector<std::byte> contents;
+};
+
+struct Stats {
+  std::atomic<std::size_t> bytes_read{};
+  std::atomic<std::size_t> bytes_written{};
+  std::atomic<std::size_t> converted{};
+  std::atomic<std::size_t> failed{};
+  std::mutex print_mutex;
+
+  void fail(const fs::path& p, std::string_view what) {
+    failed++;
+    std::lock_guard lock{print_mutex};
+    std::println(stderr, "Failed: {}: {}", p.string(), what);
+  }
+};
+//
+// End Pipeline
+//
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto opts = parse_options(argc, argv);
+  if (!opts) {
+    print_usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<std::pair<fs::path, fs::path>> files;
+  try {
+    for (const auto& entry : fs::recursive_directory_iterator{opts->input_dir}) {
+      if (!entry.is_regular_file() || entry.path().extension() != ".fseq") continue;
+      files.emplace_back(entry.path(), opts->output_dir / fs::relative(entry.path(), opts->input_dir));
+    }
+  } catch (const fs::filesystem_error& e) {
+    std::println(stderr, "Read failure: {}", e.what());
+    return 1;
+  }
+
+  // Reader -> workers -> writer. The queues are bounded so that the reader cannot run arbitrarily far
+  // ahead of the workers and writer, which keeps memory use proportional to the number of workers.
+  const std::size_t queue_capacity{2 * opts->workers};
+  BoundedQueue<Job> read_queue{queue_capacity};
+  BoundedQueue<Job> write_queue{queue_capacity};
+  Stats stats;
+  const auto start = std::chrono::steady_clock::now();
+
+  // The stages are started inside the try block so that if starting one fails, the queues can be closed
+  // before the already running stages are joined by their destructors; otherwise they would wait in pop()
+  // forever.
+  std::jthread writer;
+  std::vector<std::jthread> workers;
+  std::jthread reader;
+  try {
+    writer = std::jthread{[&] {
+      while (auto job = write_queue.pop()) {
+        try {
+          fs::create_directories(job->output.parent_path());
+          VLT::write_file_contents(job->output, job->contents);
+          stats.bytes_written += job->contents.size();
+          auto n = ++stats.converted;
+          std::lock_guard lock{stats.print_mutex};
+          std::println("[{}/{}] {}", n, files.size(), job->output.string());
+        } catch (const std::exception& e) {
+          stats.fail(job->output, e.what());
+        }
+      }
+    }};
+
+    for (unsigned i = 0; i < opts->workers; i++) {
+      workers.emplace_back([&] {
+        // Both sequences only live for the duration of one file. They are built in an arena over a
+        // per-worker buffer that is kept across files and only ever grown, so in the steady state a file
+        // costs no global heap allocations for its variables and frame buffers. Whatever does not fit
+        // spills over to the default resource and is freed with the arena.
+        std::unique_ptr<std::byte[]> buffer;
+        std::size_t buffer_size{0};
+        while (auto job = read_queue.pop()) {
+          // Room for the parsed input's channel data plus an output of similar size
+          auto wanted = 2 * job->contents.size() + 64 * 1024;
+          if (buffer_size < wanted) {
+            buffer = std::make_unique_for_overwrite<std::byte[]>(wanted);
+            buffer_size = wanted;
+          }
+          std::pmr::monotonic_buffer_resource arena{buffer.get(), buffer_size};
+          try {
+            VLT::FSEQv2 in{std::span<const std::byte>{job->contents}, &arena};
+            job->contents = VLT::convert(in, opts->conversion, &arena).serialize();
+          } catch (const std::exception& e) {
+            stats.fail(job->input, e.what());
+            job.reset();
+          }
+          if (job) write_queue.push(std::move(*job));
+        }
+      });
+    }
+
+    reader = std::jthread{[&] {
+      for (const auto& [input, output] : files) {
+        try {
+          auto contents = VLT::read_file_contents(input);
+          stats.bytes_read += contents.size();
+          read_queue.push({input, output, std::move(contents)});
+        } catch (const std::exception& e) {
+          stats.fail(input, e.what());
+        }
+      }
+      read_queue.close();
+    }};
+  } catch (const std::system_error& e) {
+    read_queue.close();
+    write_queue.close();
+    std::println(stderr, "Cannot start pipeline threads: {}", e.what());
+    return 1;
+  }
+
+  reader.join();
+  workers.clear();  // Joins the workers once the read queue has been drained
+  write_queue.close();
+  writer.join();
+
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  const auto seconds = std::max(elapsed.count(), 1e-9);
+  std::println("Converted {}/{} files ({} failed) in {:.3f} s using {} workers", stats.converted.load(),
+               files.size(), stats.failed.load(), seconds, opts->workers);
+  std::println("Read {:.1f} MiB ({:.1f} MiB/s), wrote {:.1f} MiB ({:.1f} MiB/s), {:.1f} files/s",
+               to_mib(stats.bytes_read.load()), to_mib(stats.bytes_read.load()) / seconds,
+               to_mib(stats.bytes_written.load()), to_mib(stats.bytes_written.load()) / seconds,
+               static_cast<double>(stats.converted.load()) / seconds);
+
+  return stats.failed ? 1 : 0;
+}